@@ -0,0 +1,178 @@
+/*
+Project: OGLA
+File: delimiters.hpp
+Author: Leonardo Banderali
+Created: October 18, 2026
+Last Modified: October 18, 2026
+
+Description:
+    Strings and block comments are spans of text enclosed by delimiters.  Finding them with regexes requires a search
+    per escape sequence (or a very slow regex).  This file provides a description of such spans, along with functions
+    that find them directly by scanning the text for the few characters that matter.
+
+Copyright (C) 2015 Leonardo Banderali
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+
+#ifndef OGLA_DELIMITERS_HPP
+#define OGLA_DELIMITERS_HPP
+
+// c++ standard libraries
+#include <algorithm>
+#include <string>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+//~forward declare namespace members~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+namespace ogla {
+
+template <typename charT> struct BasicDelimiters; // describes a span of text enclosed by delimiters
+
+/*
+Finds the first span described by `delimiters` in some text.  Returns true if a span was found, in which case
+`spanFirst` and `spanLast` are set to its start and one past its end (the delimiters are part of the span).  A span
+that is not closed before the end of the text is not a span.
+
+@param first: points to the the start of the text
+@param last: points to one past the end of the text
+@param delimiters: describes the span to find; its open and close delimiters must not be empty
+*/
+template <typename RandomAccessIterator, typename charT>
+bool find_delimited(RandomAccessIterator first, RandomAccessIterator last, const BasicDelimiters<charT>& delimiters,
+                    RandomAccessIterator& spanFirst, RandomAccessIterator& spanLast);
+
+}   // namespace `ogla`
+
+
+
+/*
+A `BasicDelimiters` describes a span of text such as a string literal or a block comment.  A span starts with an open
+delimiter and ends with the first close delimiter that follows it.  Inside the span, the escape character (if any)
+causes the character following it to be skipped, so that it can't close the span.  If spans are nested, every open
+delimiter found inside a span must be matched by its own close delimiter before the span can end.
+
+For example, `BasicDelimiters<char>{"\"", "\"", "\\"}` describes C string literals and
+`BasicDelimiters<char>{"(*", "*)", "", true}` describes (nested) Pascal comments.
+*/
+template <typename charT>
+struct ogla::BasicDelimiters {
+    std::basic_string<charT> open;      // starts a span
+    std::basic_string<charT> close;     // ends a span
+    std::basic_string<charT> escape;    // the escape character, or empty if there is none
+    bool nested = false;
+};
+
+
+
+namespace ogla { namespace detail {
+
+/*
+returns the first position in the text holding one of the characters `a`, `b`, or `c` (or `last` if there is none)
+*/
+template <typename RandomAccessIterator, typename charT>
+auto find_any_of(RandomAccessIterator first, RandomAccessIterator last, charT a, charT b, charT c) -> RandomAccessIterator {
+    return std::find_if(first, last, [=](charT x){ return x == a || x == b || x == c; });
+}
+
+/*
+Same as above, for contiguous narrow text.  With SSE2, 16 characters are compared to all three characters at once.
+*/
+inline auto find_any_of(const char* first, const char* last, char a, char b, char c) -> const char* {
+#if defined(__SSE2__)
+    const auto va = _mm_set1_epi8(a);
+    const auto vb = _mm_set1_epi8(b);
+    const auto vc = _mm_set1_epi8(c);
+    for (; last - first >= 16; first += 16) {
+        const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+        const auto found = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, va), _mm_cmpeq_epi8(chunk, vb)),
+                                        _mm_cmpeq_epi8(chunk, vc));
+        const auto mask = _mm_movemask_epi8(found);
+        if (mask != 0)
+            return first + __builtin_ctz(mask);
+    }
+#endif
+    for (; first != last; ++first) {
+        if (*first == a || *first == b || *first == c)
+            return first;
+    }
+    return last;
+}
+
+inline auto find_any_of(std::string::const_iterator first, std::string::const_iterator last, char a, char b, char c)
+-> std::string::const_iterator {
+    if (first == last)
+        return last;
+    const auto p = &*first;
+    return first + (find_any_of(p, p + (last - first), a, b, c) - p);
+}
+
+/*
+returns true if the text starting at `pos` begins with `delimiter`
+*/
+template <typename RandomAccessIterator, typename charT>
+bool starts_with(RandomAccessIterator pos, RandomAccessIterator last, const std::basic_string<charT>& delimiter) {
+    return static_cast<std::size_t>(last - pos) >= delimiter.size() && std::equal(delimiter.cbegin(), delimiter.cend(), pos);
+}
+
+}}  // namespace `ogla::detail`
+
+
+
+/*
+Finds the first span described by `delimiters` in some text.
+*/
+template <typename RandomAccessIterator, typename charT>
+bool ogla::find_delimited(RandomAccessIterator first, RandomAccessIterator last, const BasicDelimiters<charT>& delimiters,
+                          RandomAccessIterator& spanFirst, RandomAccessIterator& spanLast) {
+    const auto& open = delimiters.open;
+    const auto& close = delimiters.close;
+
+    // find the open delimiter
+    auto pos = first;
+    while (true) {
+        pos = detail::find_any_of(pos, last, open[0], open[0], open[0]);
+        if (pos == last)
+            return false;
+        if (detail::starts_with(pos, last, open))
+            break;
+        ++pos;
+    }
+    spanFirst = pos;
+    pos += open.size();
+
+    // find the matching close delimiter, only stopping at characters that could change the state of the span
+    const auto escape = delimiters.escape.empty() ? close[0] : delimiters.escape[0];
+    const auto nestedOpen = delimiters.nested ? open[0] : close[0];
+    int depth = 0;
+    while (true) {
+        pos = detail::find_any_of(pos, last, close[0], escape, nestedOpen);
+        if (pos == last)
+            return false;
+
+        if (!delimiters.escape.empty() && *pos == escape) {
+            if (last - pos < 2)
+                return false;
+            pos += 2;
+        } else if (detail::starts_with(pos, last, close)) {
+            pos += close.size();
+            if (depth == 0)
+                break;
+            depth--;
+        } else if (delimiters.nested && detail::starts_with(pos, last, open)) {
+            pos += open.size();
+            depth++;
+        } else {
+            ++pos;
+        }
+    }
+    spanLast = pos;
+
+    return true;
+}
+
+#endif//OGLA_DELIMITERS_HPP
@@ -3,7 +3,7 @@ Project: OGLA
 File: lexers.hpp
 Author: Leonardo Banderali
 Created: August 30, 2015
-Last Modified: December 25, 2015
+Last Modified: October 18, 2026
 
 Description:
     This file declares some lexers that make use of the facilities provided by this library.  As with the rest of this
@@ -71,31 +71,31 @@ Generates a list of tokens form some text and the rules stored in a grammar.
 template <typename RandomAccessIterator, typename TokenTypeT, typename charT> auto
 ogla::basic_analyze(RandomAccessIterator first, RandomAccessIterator last, const BasicGrammar<TokenTypeT, charT>& grammar)
 -> typename ogla::BasicTokenList<RandomAccessIterator, TokenTypeT> {
-    using RegExMatch = typename BasicToken<RandomAccessIterator, TokenTypeT>::RegExMatch;
+    using Token = BasicToken<RandomAccessIterator, TokenTypeT>;
     using GrammarRule = BasicGrammarRule<TokenTypeT, charT>;
 
     BasicTokenList<RandomAccessIterator, TokenTypeT> tokenList;
     RandomAccessIterator currentPosition = first;
     auto currentRuleList = 0;
 
+    typename Token::SubMatch firstMatch;
+    typename Token::SubMatch m;
+    typename Token::RegExMatch scratch;
     while (currentPosition < last) {
-        GrammarRule rule{-1};
-        RegExMatch firstMatch;
-        RegExMatch m;
+        const GrammarRule* rule = nullptr;
         for (const auto& r : grammar[currentRuleList]) {
-            if (std::regex_search(currentPosition, last, m, r.regex()) && (firstMatch.empty() || m.position() < firstMatch.position() )) {
-                firstMatch = std::move(m);
-                rule = r;
+            if (r.search(currentPosition, last, m, scratch) && (rule == nullptr || m.first < firstMatch.first )) {
+                firstMatch = m;
+                rule = &r;
             }
         }
 
-        if (firstMatch.empty()) {
+        if (rule == nullptr) {
             break;
         } else {
-            currentPosition += firstMatch.position();
-            tokenList.push_back(make_token(rule.type(), firstMatch, currentPosition - first)); // append the new token to the list
-            currentPosition += firstMatch.length();
-            currentRuleList = rule.nextState();
+            tokenList.push_back(Token{rule->type(), firstMatch.first, firstMatch.second, static_cast<int>(firstMatch.first - first)}); // append the new token to the list
+            currentPosition = firstMatch.second;
+            currentRuleList = rule->nextState();
         }
     }
 
@@ -113,6 +113,11 @@ Upon instantiation, calling `current()` will return the first token in the text.
 return the token following the current one.  This also sets the new token as the current one.  The position of tokens
 is defined relative to the starting position of the text (called `first`).  An empty token is returned if no token
 could be found in the text at any time.  This effectively terminates the analysis.
+
+The lexer reuses its internal buffers between calls and remembers the result of `peek()` so that the following call to
+`next()` does not search the text again.  Once the first token has been found, calling `next()` or `peek()` does not
+allocate any memory, apart from what `std::regex_search` may allocate internally and what copying a `TokenTypeT`
+requires (nothing for enumerations, integers, or short strings).
 */
 template <typename RandomAccessIterator, typename TokenTypeT, typename charT>
 class ogla::BasicLexer {
@@ -128,13 +133,13 @@ class ogla::BasicLexer {
                 other rule lists that is internally pointed to.  Otherwise, behaviour is undefined.
         */
 
-        auto current() const -> Token;
+        auto current() const -> const Token&;
         /*  returns the token currently being referenced */
 
-        auto next() -> Token;
+        auto next() -> const Token&;
         /*  generates, returns, and moves the internal reference to the next token in the text */
 
-        auto peek() -> Token;
+        auto peek() -> const Token&;
         /*  generates and returns the next token but does not set the internal reference to it */
 
     private:
@@ -144,6 +149,15 @@ class ogla::BasicLexer {
         Grammar grammar;
         BasicGrammarIndex currentRuleList;
         Token currentToken;
+
+        Token peekedToken;                      // the token following `currentToken`, valid if `hasPeeked` is set
+        RandomAccessIterator peekedPosition;    // the position right after `peekedToken`
+        BasicGrammarIndex peekedRuleList;       // the state of the lexer after finding `peekedToken`
+        bool hasPeeked;
+
+        typename Token::SubMatch firstMatch;
+        typename Token::SubMatch match;
+        typename Token::RegExMatch scratch;     // used by regex searches, kept as a member so its storage can be reused
 };
 
 
@@ -156,15 +170,16 @@ class ogla::BasicLexer {
 */
 template <typename RandomAccessIterator, typename TokenTypeT, typename charT>
 ogla::BasicLexer<RandomAccessIterator, TokenTypeT, charT>::BasicLexer(RandomAccessIterator _first, RandomAccessIterator _last, const BasicGrammar<TokenTypeT, charT>& _grammar)
-: first{_first}, last{_last}, currentPosition{_first}, grammar{_grammar}, currentRuleList{0} {
-    currentToken = next();
+: first{_first}, last{_last}, currentPosition{_first}, grammar{_grammar}, currentRuleList{0},
+  peekedPosition{_first}, peekedRuleList{0}, hasPeeked{false} {
+    next();
 }
 
 /*
 returns the token currently being referenced
 */
 template <typename RandomAccessIterator, typename TokenTypeT, typename charT>
-auto ogla::BasicLexer<RandomAccessIterator, TokenTypeT, charT>::current() const -> Token {
+auto ogla::BasicLexer<RandomAccessIterator, TokenTypeT, charT>::current() const -> const Token& {
     return currentToken;
 }
 
@@ -172,29 +187,14 @@ auto ogla::BasicLexer<RandomAccessIterator, TokenTypeT, charT>::current() const
 generates, returns, and moves the internal reference to the next token in the text
 */
 template <typename RandomAccessIterator, typename TokenTypeT, typename charT>
-auto ogla::BasicLexer<RandomAccessIterator, TokenTypeT, charT>::next() -> Token {
-    if (currentRuleList < 0 || currentPosition >= last) {
-        currentToken = Token{}; // if the grammar index is negative, return an empty token
-    } else {
-        GrammarRule rule{-1};
-        typename Token::RegExMatch firstMatch;
-        typename Token::RegExMatch m;
-        for (const auto& r : grammar[currentRuleList]) {
-            if (std::regex_search(currentPosition, last, m, r.regex()) && (firstMatch.empty() || m.position() < firstMatch.position() )) {
-                firstMatch = std::move(m);
-                rule = r;
-            }
-        }
-
-        if (firstMatch.empty()) {
-            currentToken = Token{};
-        } else {
-            currentPosition += firstMatch.position();
-            currentToken = make_token(rule.type(), firstMatch, currentPosition - first);
-            currentPosition += firstMatch.length();
-            currentRuleList = rule.nextState();
-        }
-    }
+auto ogla::BasicLexer<RandomAccessIterator, TokenTypeT, charT>::next() -> const Token& {
+    peek();
+    currentToken = peekedToken; // copy assignment reuses whatever storage `currentToken` already owns
+    if (!currentToken.empty()) {
+        currentPosition = peekedPosition;
+        currentRuleList = peekedRuleList;
+        hasPeeked = false;
+    }   // otherwise, the lexer is stuck and the (empty) peeked token remains valid
 
     return currentToken;
 }
@@ -203,21 +203,30 @@ auto ogla::BasicLexer<RandomAccessIterator, TokenTypeT, charT>::next() -> Token
 generates and returns the next token but does not set the internal reference to it
 */
 template <typename RandomAccessIterator, typename TokenTypeT, typename charT>
-auto ogla::BasicLexer<RandomAccessIterator, TokenTypeT, charT>::peek() -> Token {
-    auto returnToken = Token{};
+auto ogla::BasicLexer<RandomAccessIterator, TokenTypeT, charT>::peek() -> const Token& {
+    if (hasPeeked)
+        return peekedToken;
+
+    peekedToken = Token{}; // if the grammar index is negative or no token is found, return an empty token
 
     if (currentRuleList >= 0 && currentPosition < last) {
-        typename Token::RegExMatch firstMatch;
-        typename Token::RegExMatch m;
+        const GrammarRule* rule = nullptr;
         for (const auto& r : grammar[currentRuleList]) {
-            if (std::regex_search(currentPosition, last, m, r.regex()) && (firstMatch.empty() || m.position() < firstMatch.position() )) {
-                firstMatch = std::move(m);
-                returnToken = make_token(r.type(), firstMatch, firstMatch.position() + currentPosition - first);
+            if (r.search(currentPosition, last, match, scratch) && (rule == nullptr || match.first < firstMatch.first )) {
+                firstMatch = match;
+                rule = &r;
             }
         }
+
+        if (rule != nullptr) {
+            peekedToken = Token{rule->type(), firstMatch.first, firstMatch.second, static_cast<int>(firstMatch.first - first)};
+            peekedPosition = firstMatch.second;
+            peekedRuleList = rule->nextState();
+        }
     }
+    hasPeeked = true;
 
-    return returnToken;
+    return peekedToken;
 }
 
 
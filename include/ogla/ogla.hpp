@@ -3,7 +3,7 @@ Project: OGLA
 File: ogla.hpp
 Author: Leonardo Banderali
 Created: March 07, 2015
-Last Modified: July 12, 2015
+Last Modified: October 18, 2026
 
 Description:
     OGLA is generic lexical analyzer intended for quick and fast integration into
@@ -24,5 +24,7 @@ Distributed under the Boost Software License, Version 1.0.
 #include "token.hpp"
 #include "grammar.hpp"
 #include "lexers.hpp"
+#include "optimizer.hpp"
+#include "token_stream.hpp"
 
 #endif  //OGLA_HPP
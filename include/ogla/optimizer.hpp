@@ -0,0 +1,289 @@
+/*
+Project: OGLA
+File: optimizer.hpp
+Author: Leonardo Banderali
+Created: October 18, 2026
+Last Modified: October 18, 2026
+
+Description:
+    Grammars are written one rule at a time, which often leaves rules that can never produce a token, states that can
+    never be reached, and several rules that could be searched for at once.  This file provides a pass that finds
+    these problems, reports them, and rewrites a grammar into an equivalent one that is cheaper to lex with.
+
+Copyright (C) 2015 Leonardo Banderali
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+
+#ifndef OGLA_OPTIMIZER_HPP
+#define OGLA_OPTIMIZER_HPP
+
+// project headers
+#include "grammar.hpp"
+
+// c++ standard libraries
+#include <vector>
+#include <string>
+#include <ostream>
+
+
+
+//~forward declare namespace members~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+namespace ogla {
+
+struct GrammarReport;   // describes what `optimize_grammar()` found in (and did to) a grammar
+
+/*
+Returns a grammar that produces exactly the same tokens as `grammar` but requires fewer regex searches to do so.  Rules
+that can never produce a token are removed, the rule lists of unreachable states are emptied, and literal rules that
+can be searched for together are merged into a single rule.  Indices of states are preserved.
+
+@param grammar: the grammar to optimize
+@param report: if not null, is filled with what was found in (and done to) the grammar
+*/
+template <typename TokenTypeT, typename charT>
+auto optimize_grammar(const BasicGrammar<TokenTypeT, charT>& grammar, GrammarReport* report = nullptr)
+-> BasicGrammar<TokenTypeT, charT>;
+
+auto operator<<(std::ostream& os, const GrammarReport& report) -> std::ostream&;
+/*  writes a human readable version of the report, one finding per line */
+
+}   // namespace `ogla`
+
+
+
+/*
+A `GrammarReport` lists what `optimize_grammar()` found in a grammar.  States and rules are identified by their indices
+in the original grammar (a rule is identified by the index of its state and its index in that state's rule list).
+*/
+struct ogla::GrammarReport {
+    struct ShadowedRule {
+        BasicGrammarIndex state;
+        int rule;
+        int shadowedBy;     // the earlier rule that always matches at the same or an earlier position
+    };
+
+    struct DanglingRule {
+        BasicGrammarIndex state;
+        int rule;
+        BasicGrammarIndex nextState;    // the state the rule points to, which does not exist
+    };
+
+    struct MergedRules {
+        BasicGrammarIndex state;
+        std::vector<int> rules;     // the literal rules that were merged into a single alternation
+    };
+
+    std::vector<BasicGrammarIndex> unreachableStates;
+    std::vector<ShadowedRule> shadowedRules;
+    std::vector<DanglingRule> danglingRules;
+    std::vector<MergedRules> mergedRules;
+
+    bool empty() const {
+        return unreachableStates.empty() && shadowedRules.empty() && danglingRules.empty() && mergedRules.empty();
+    }
+};
+
+
+
+/*###################################################################################################################
+### The analysis below only relies on rules whose pattern is known (see `BasicRule::pattern()`).  Rules created    ##
+### from regex objects or delimiters are left as they are.                                                       ##
+###                                                                                                               ##
+### A rule is "literal" if its pattern only matches one fixed string.  Since the lexer picks the rule matching     ##
+### the earliest, with ties going to the rule that comes first, a literal rule that starts with the literal of an  ##
+### earlier rule can never win.  Two literal rules that are not prefixes of each other can never match at the     ##
+### same position, so the order in which they are checked does not matter.  Finally, an ECMAScript alternation    ##
+### also matches at the earliest position and prefers its first alternative, so adjacent literal rules of the     ##
+### same type and next state behave exactly like a single rule matching the alternation of their literals.       ##
+###################################################################################################################*/
+
+namespace ogla { namespace detail {
+
+/*
+returns true if `c` has a special meaning in ECMAScript regexes
+*/
+template <typename charT>
+bool is_regex_syntax_char(charT c) {
+    static const std::string syntaxChars{"^$\\.*+?()[]{}|"};
+    return c >= 0 && c < 128 && syntaxChars.find(static_cast<char>(c)) != std::string::npos;
+}
+
+/*
+If `pattern` only matches a fixed, non-empty string, stores that string in `literal` and returns true.
+*/
+template <typename charT>
+bool parse_literal(const std::basic_string<charT>& pattern, std::basic_string<charT>& literal) {
+    literal.clear();
+    for (auto i = pattern.cbegin(), end = pattern.cend(); i != end; ++i) {
+        if (*i == charT('\\')) {
+            ++i;
+            if (i == end || !is_regex_syntax_char(*i))
+                return false;   // escapes like `\b` or `\d` are not literal
+        } else if (is_regex_syntax_char(*i)) {
+            return false;
+        }
+        literal.push_back(*i);
+    }
+    return !literal.empty();
+}
+
+/*
+returns `literal` as a pattern that matches it
+*/
+template <typename charT>
+auto escape_literal(const std::basic_string<charT>& literal) -> std::basic_string<charT> {
+    std::basic_string<charT> pattern;
+    for (auto c : literal) {
+        if (is_regex_syntax_char(c))
+            pattern.push_back(charT('\\'));
+        pattern.push_back(c);
+    }
+    return pattern;
+}
+
+/*
+returns true if `prefix` is a prefix of `str`
+*/
+template <typename charT>
+bool starts_with(const std::basic_string<charT>& str, const std::basic_string<charT>& prefix) {
+    return prefix.size() <= str.size() && str.compare(0, prefix.size(), prefix) == 0;
+}
+
+}}  // namespace `ogla::detail`
+
+
+
+/*
+Returns a grammar that produces exactly the same tokens as `grammar` but requires fewer regex searches to do so.
+*/
+template <typename TokenTypeT, typename charT>
+auto ogla::optimize_grammar(const BasicGrammar<TokenTypeT, charT>& grammar, GrammarReport* report)
+-> ogla::BasicGrammar<TokenTypeT, charT> {
+    using String = std::basic_string<charT>;
+
+    GrammarReport r;
+    const auto stateCount = static_cast<BasicGrammarIndex>(grammar.size());
+
+    // find the states the lexer can reach, starting from state `0`
+    std::vector<bool> reachable(grammar.size(), false);
+    std::vector<BasicGrammarIndex> toVisit;
+    if (stateCount > 0) {
+        reachable[0] = true;
+        toVisit.push_back(0);
+    }
+    while (!toVisit.empty()) {
+        auto state = toVisit.back();
+        toVisit.pop_back();
+        for (int i = 0, l = grammar[state].size(); i < l; i++) {
+            auto next = grammar[state][i].nextState();
+            if (next >= stateCount) {
+                r.danglingRules.push_back({state, i, next});
+            } else if (next >= 0 && !reachable[next]) {
+                reachable[next] = true;
+                toVisit.push_back(next);
+            }
+        }
+    }
+
+    BasicGrammar<TokenTypeT, charT> optimized(grammar.size());
+    for (BasicGrammarIndex state = 0; state < stateCount; state++) {
+        if (!reachable[state]) {
+            r.unreachableStates.push_back(state);
+            continue;
+        }
+        const auto& rules = grammar[state];
+
+        // get the literal matched by each rule, if any
+        std::vector<String> literals(rules.size());
+        std::vector<bool> isLiteral(rules.size());
+        for (int i = 0, l = rules.size(); i < l; i++)
+            isLiteral[i] = detail::parse_literal(rules[i].pattern(), literals[i]);
+
+        // group the rules that can never win with the earlier rule that prevents them from winning
+        std::vector<std::vector<int>> groups;   // each group will become a single rule
+        for (int j = 0, l = rules.size(); j < l; j++) {
+            int shadowedBy = -1;
+            for (int i = 0; i < j && shadowedBy < 0; i++) {
+                if (isLiteral[i] && isLiteral[j] ? detail::starts_with(literals[j], literals[i])
+                                                 : !rules[i].pattern().empty() && rules[i].pattern() == rules[j].pattern())
+                    shadowedBy = i;
+            }
+            if (shadowedBy >= 0) {
+                r.shadowedRules.push_back({state, j, shadowedBy});
+                continue;
+            }
+
+            // move literal rules up to an earlier literal rule of the same kind, as long as they never tie with
+            // any of the rules in between
+            auto target = groups.rend();
+            if (isLiteral[j]) {
+                for (auto g = groups.rbegin(); g != groups.rend(); ++g) {
+                    const auto& first = rules[g->front()];
+                    if (isLiteral[g->front()] && first.type() == rules[j].type() && first.nextState() == rules[j].nextState()) {
+                        target = g;
+                        break;
+                    }
+
+                    bool commutes = true;
+                    for (auto i : *g) {
+                        commutes = commutes && isLiteral[i] && !detail::starts_with(literals[i], literals[j])
+                                                            && !detail::starts_with(literals[j], literals[i]);
+                    }
+                    if (!commutes)
+                        break;
+                }
+            }
+
+            if (target != groups.rend())
+                target->push_back(j);
+            else
+                groups.push_back({j});
+        }
+
+        for (const auto& g : groups) {
+            if (g.size() == 1) {
+                optimized[state].push_back(rules[g.front()]);
+            } else {
+                String alternation;
+                for (auto i : g) {
+                    if (!alternation.empty())
+                        alternation.push_back(charT('|'));
+                    alternation += detail::escape_literal(literals[i]);
+                }
+                const auto& first = rules[g.front()];
+                optimized[state].push_back(make_basic_rule(first.type(), alternation, first.nextState()));
+                r.mergedRules.push_back({state, g});
+            }
+        }
+    }
+
+    if (report != nullptr)
+        *report = std::move(r);
+    return optimized;
+}
+
+
+
+/*
+writes a human readable version of the report, one finding per line
+*/
+inline auto ogla::operator<<(std::ostream& os, const GrammarReport& report) -> std::ostream& {
+    for (auto state : report.unreachableStates)
+        os << "state " << state << " is unreachable\n";
+    for (const auto& d : report.danglingRules)
+        os << "state " << d.state << ", rule " << d.rule << ": next state " << d.nextState << " does not exist\n";
+    for (const auto& s : report.shadowedRules)
+        os << "state " << s.state << ", rule " << s.rule << ": can never match, always shadowed by rule " << s.shadowedBy << "\n";
+    for (const auto& m : report.mergedRules) {
+        os << "state " << m.state << ", rules";
+        for (auto rule : m.rules)
+            os << " " << rule;
+        os << ": merged into a single literal alternation\n";
+    }
+    return os;
+}
+
+#endif//OGLA_OPTIMIZER_HPP
@@ -3,7 +3,7 @@ Project: OGLA
 File: rule.hpp
 Author: Leonardo Banderali
 Created: December 17, 2015
-Last Modified: December 18, 2015
+Last Modified: October 18, 2026
 
 Description:
     Lexers use a set of `Rule`s to find tokens. This file provides a class template for the rules used by OGLA lexers.
@@ -17,8 +17,12 @@ Distributed under the Boost Software License, Version 1.0.
 #ifndef OGLA_RULE_HPP
 #define OGLA_RULE_HPP
 
+// project headers
+#include "delimiters.hpp"
+
 // c++ standard libraries
 #include <regex>
+#include <string>
 
 //~forward declare namespace members~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
@@ -31,6 +35,16 @@ auto make_basic_rule(const TokenTypeT& type, const std::basic_regex<charT>& rege
 -> BasicRule<TokenTypeT, charT, LexerStateT>;
 /*  convenience function that constructs and returns a `BasicRule` object */
 
+template <typename TokenTypeT, typename charT, typename LexerStateT>
+auto make_basic_rule(const TokenTypeT& type, const std::basic_string<charT>& pattern, const LexerStateT& nextState)
+-> BasicRule<TokenTypeT, charT, LexerStateT>;
+/*  convenience function that constructs and returns a `BasicRule` object which remembers its regex pattern */
+
+template <typename TokenTypeT, typename charT, typename LexerStateT>
+auto make_basic_rule(const TokenTypeT& type, const BasicDelimiters<charT>& delimiters, const LexerStateT& nextState)
+-> BasicRule<TokenTypeT, charT, LexerStateT>;
+/*  convenience function that constructs and returns a `BasicRule` object which finds delimited spans */
+
 }   // `ogla` namepsace
 
 
@@ -48,6 +62,12 @@ Rules have three basic properties:
 
 Each rule should only be used to search for a single category of token.  For example, "keyword" can be a category.
 
+A rule can be created either from a regex object or from a pattern string.  In the latter case, the rule also keeps the
+pattern (which is compiled using the default ECMAScript syntax) so that tools like `optimize_grammar()` can inspect it.
+
+Instead of a regular expression, a rule can also use a set of delimiters (see `BasicDelimiters`).  Such a rule finds
+a whole delimited span (e.g. a string literal or a block comment) as a single token, without using regexes at all.
+
 The three template paramaters are:
 * TokenTypeT: the data type for the identifying the type/category of tokens the rule matches
 * LexerStateT: the type used to represent lexer states
@@ -65,19 +85,37 @@ class ogla::BasicRule {
         BasicRule(LexerStateT _nState) : nState{_nState} {}
         BasicRule(const TokenTypeT& _type, const std::basic_regex<charT>& _regex, LexerStateT _nState)
             : tokenType{_type}, rgx{_regex}, nState{_nState} {}
+        BasicRule(const TokenTypeT& _type, const std::basic_string<charT>& _pattern, LexerStateT _nState)
+            : tokenType{_type}, rgx{_pattern}, src{_pattern}, nState{_nState} {}
+        BasicRule(const TokenTypeT& _type, const BasicDelimiters<charT>& _delimiters, LexerStateT _nState)
+            : tokenType{_type}, delims{_delimiters}, isDelimited{true}, nState{_nState} {}
 
         auto type() const -> TokenType;
         /*  returns the type of token the rule finds */
 
-        auto regex() const -> RegEx;
+        auto regex() const -> const RegEx&;
         /*  returns the regular expression used to find the token associated with this rule */
 
         auto nextState() const -> LexerState;
         /*  returns the state the lexer should have after finding a token from this rule */
 
+        auto pattern() const -> const std::basic_string<charT>&;
+        /*  returns the pattern the rule's regex was compiled from (empty if the rule was created from a regex object) */
+
+        auto delimiters() const -> const BasicDelimiters<charT>*;
+        /*  returns the delimiters of the spans found by this rule (null if the rule uses a regex) */
+
+        template <typename RandomAccessIterator>
+        bool search(RandomAccessIterator first, RandomAccessIterator last, std::sub_match<RandomAccessIterator>& result,
+                    std::match_results<RandomAccessIterator>& scratch) const;
+        /*  finds the first token matching this rule in some text; `scratch` is used (and reused) for regex searches */
+
     private:
         TokenType tokenType;
         RegEx rgx;              // holds the regular expression (regex) used to indentify the token
+        std::basic_string<charT> src;   // the pattern `rgx` was compiled from, if known
+        BasicDelimiters<charT> delims;  // used instead of `rgx` if `isDelimited` is set
+        bool isDelimited = false;
         LexerState nState;      // points to (but does not own) the next rules to be used for tokenization
 };
 
@@ -93,7 +131,7 @@ auto ogla::BasicRule<TokenTypeT, charT, LexerStateT>::type() const -> TokenType
 returns the regular expression used to find the token associated with this rule
 */
 template <typename TokenTypeT, typename charT, typename LexerStateT>
-auto ogla::BasicRule<TokenTypeT, charT, LexerStateT>::regex() const -> RegEx {
+auto ogla::BasicRule<TokenTypeT, charT, LexerStateT>::regex() const -> const RegEx& {
     return rgx;
 }
 
@@ -105,6 +143,47 @@ auto ogla::BasicRule<TokenTypeT, charT, LexerStateT>::nextState() const -> Lexer
     return nState;
 }
 
+/*
+returns the pattern the rule's regex was compiled from (empty if the rule was created from a regex object)
+*/
+template <typename TokenTypeT, typename charT, typename LexerStateT>
+auto ogla::BasicRule<TokenTypeT, charT, LexerStateT>::pattern() const -> const std::basic_string<charT>& {
+    return src;
+}
+
+/*
+returns the delimiters of the spans found by this rule (null if the rule uses a regex)
+*/
+template <typename TokenTypeT, typename charT, typename LexerStateT>
+auto ogla::BasicRule<TokenTypeT, charT, LexerStateT>::delimiters() const -> const BasicDelimiters<charT>* {
+    return isDelimited ? &delims : nullptr;
+}
+
+/*
+Finds the first token matching this rule in some text.  Returns true if a token was found, in which case `result` is
+set to the range of its lexeme.
+
+@param first: points to the the start of the text
+@param last: points to one past the end of the text
+@param result: receives the range of the lexeme found
+@param scratch: used for regex searches; reusing it between calls avoids reallocating its storage
+*/
+template <typename TokenTypeT, typename charT, typename LexerStateT>
+template <typename RandomAccessIterator>
+bool ogla::BasicRule<TokenTypeT, charT, LexerStateT>::search(RandomAccessIterator first, RandomAccessIterator last,
+        std::sub_match<RandomAccessIterator>& result, std::match_results<RandomAccessIterator>& scratch) const {
+    if (isDelimited) {
+        result.matched = find_delimited(first, last, delims, result.first, result.second);
+    } else {
+        result.matched = std::regex_search(first, last, scratch, rgx);
+        if (result.matched) {
+            result.first = scratch[0].first;
+            result.second = scratch[0].second;
+        }
+    }
+    return result.matched;
+}
+
 
 
 /*
@@ -116,4 +195,22 @@ auto ogla::make_basic_rule(const TokenTypeT& type, const std::basic_regex<charT>
     return BasicRule<TokenTypeT, charT, LexerStateT>{type, regex, nextState};
 }
 
+/*
+convenience function that constructs and returns a `BasicRule` object which remembers its regex pattern
+*/
+template <typename TokenTypeT, typename charT, typename LexerStateT>
+auto ogla::make_basic_rule(const TokenTypeT& type, const std::basic_string<charT>& pattern, const LexerStateT& nextState)
+-> ogla::BasicRule<TokenTypeT, charT, LexerStateT> {
+    return BasicRule<TokenTypeT, charT, LexerStateT>{type, pattern, nextState};
+}
+
+/*
+convenience function that constructs and returns a `BasicRule` object which finds delimited spans
+*/
+template <typename TokenTypeT, typename charT, typename LexerStateT>
+auto ogla::make_basic_rule(const TokenTypeT& type, const BasicDelimiters<charT>& delimiters, const LexerStateT& nextState)
+-> ogla::BasicRule<TokenTypeT, charT, LexerStateT> {
+    return BasicRule<TokenTypeT, charT, LexerStateT>{type, delimiters, nextState};
+}
+
 #endif//OGLA_RULE_HPP
@@ -3,7 +3,7 @@ Project: OGLA
 File: token.hpp
 Author: Leonardo Banderali
 Created: July 7, 2015
-Last Modified: December 18, 2015
+Last Modified: October 18, 2026
 
 Description:
     A `Token` is a unit of analyzed text and is identified using a `Rule`.  These form the basic building blocks of the
@@ -24,6 +24,7 @@ Distributed under the Boost Software License, Version 1.0.
 // c++ standard libraries
 #include <string>
 #include <vector>
+#include <algorithm>
 
 //~forward declare namespace members~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
@@ -57,16 +58,26 @@ The template paramaters are:
 * TokenTypeT: the data type for the identifying the type/category of tokens the rule matches
 * BidirectionalIterator: the iterator used to store regex matches
 
+Only the range of the lexeme is kept from the match used to create a token (not the whole `match_results` object).  As a
+result, copying a token never allocates memory unless copying its `TokenTypeT` does.
+
 */
 template <typename BidirectionalIterator, typename TokenTypeT>
 class ogla::BasicToken {
     public:
         using TokenType = TokenTypeT;
         using RegExMatch = std::match_results<BidirectionalIterator>;
+        using SubMatch = std::sub_match<BidirectionalIterator>;
 
         BasicToken() = default;
         BasicToken(TokenTypeT _tokenType, const std::match_results<BidirectionalIterator>& _match, int _pos = -1)
-            :tokenType{_tokenType}, match{_match}, pos{_pos} {}
+            :tokenType{_tokenType}, match{_match.empty() ? SubMatch{} : _match[0]}, pos{_pos} {}
+        BasicToken(TokenTypeT _tokenType, BidirectionalIterator _first, BidirectionalIterator _last, int _pos = -1)
+            :tokenType{_tokenType}, pos{_pos} {
+            match.first = _first;
+            match.second = _last;
+            match.matched = true;
+        }
 
         bool empty() const;
         /*  returns true if the token is the result of an empty match (search result is empty) */
@@ -80,13 +91,16 @@ class ogla::BasicToken {
         auto lexeme() const -> typename RegExMatch::string_type;
         /*  returns the lexeme of this token */
 
+        int length() const;
+        /*  returns the length of the lexeme of this token (without copying it) */
+
         bool operator==(const BasicToken& other) const;
 
         bool operator!=(const BasicToken& other) const;
 
     private:
         TokenTypeT tokenType;
-        RegExMatch match;   // the matched lexeme associated with the token
+        SubMatch match;     // the range of the matched lexeme associated with the token
         int pos = -1;       // the assigned position of the token in the text (-1 is "no/don't care position")
 };
 
@@ -95,7 +109,7 @@ returns true if the token is the result of an empty match (search result is empt
 */
 template <typename BidirectionalIterator, typename TokenTypeT>
 bool ogla::BasicToken<BidirectionalIterator, TokenTypeT>::empty() const {
-    return match.empty();
+    return !match.matched;
 }
 
 /*
@@ -119,15 +133,24 @@ returns the lexeme of this token
 */
 template <typename BidirectionalIterator, typename TokenTypeT>
 auto ogla::BasicToken<BidirectionalIterator, TokenTypeT>::lexeme() const -> typename RegExMatch::string_type {
-    if (match.empty())
-        return std::string();
+    if (empty())
+        return typename RegExMatch::string_type();
     else
         return match.str();
 }
 
+/*
+returns the length of the lexeme of this token (without copying it)
+*/
+template <typename BidirectionalIterator, typename TokenTypeT>
+int ogla::BasicToken<BidirectionalIterator, TokenTypeT>::length() const {
+    return empty() ? 0 : match.length();
+}
+
 template <typename BidirectionalIterator, typename TokenTypeT>
 bool ogla::BasicToken<BidirectionalIterator, TokenTypeT>::operator==(const BasicToken& other) const {
-    return tokenType == other.tokenType && match == other.match && pos == other.pos;
+    return tokenType == other.tokenType && pos == other.pos && empty() == other.empty()
+        && std::equal(match.first, match.second, other.match.first, other.match.second); // compare lexemes without copying them
 }
 
 template <typename BidirectionalIterator, typename TokenTypeT>
@@ -0,0 +1,388 @@
+/*
+Project: OGLA
+File: token_stream.hpp
+Author: Leonardo Banderali
+Created: October 18, 2026
+Last Modified: October 18, 2026
+
+Description:
+    Lexing the same text over and over is wasteful.  This file provides a compact binary format for storing the tokens
+    found in a text, along with a view that reads them back without running a lexer.  Since the stream records a hash
+    of the text it was created from, it can be used as a cache: if the hash of the text still matches, the tokens in
+    the stream are the ones a lexer would find.
+
+Copyright (C) 2015 Leonardo Banderali
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+
+#ifndef OGLA_TOKEN_STREAM_HPP
+#define OGLA_TOKEN_STREAM_HPP
+
+// project headers
+#include "grammar.hpp"
+
+// c++ standard libraries
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <iterator>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+/*#####################################################################################################################
+### A token stream is made of a header followed by one record per token.  All integers are unsigned LEB128 varints,  ##
+### except for the hash which is stored as 8 little-endian bytes.                                                     ##
+###                                                                                                                   ##
+###     header: "OGLT", format version (1 byte), text length, text hash, type count, token count                      ##
+###     record: gap from the end of the previous token, lexeme length, type ID                                        ##
+###                                                                                                                   ##
+### A type ID is the index of a token type in a list of types shared by the writer and the reader, such as the one   ##
+### returned by `grammar_token_types()`.  Since only the IDs are stored, a stream should be discarded whenever this   ##
+### list (or the grammar that produced the tokens) changes.                                                          ##
+#####################################################################################################################*/
+
+//~forward declare namespace members~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+namespace ogla {
+
+template <typename RandomAccessIterator, typename TokenTypeT> class BasicTokenStreamView; // reads tokens from a stream
+
+template <typename TokenTypeT, typename charT>
+auto grammar_token_types(const BasicGrammar<TokenTypeT, charT>& grammar) -> std::vector<TokenTypeT>;
+/*  returns the distinct token types found by the rules of a grammar, in the order they first appear */
+
+template <typename RandomAccessIterator>
+auto text_hash(RandomAccessIterator first, RandomAccessIterator last) -> std::uint64_t;
+/*  returns the hash of some text that is recorded in token streams (64 bit FNV-1a) */
+
+/*
+Writes a list of tokens to a stream.  The tokens must be non-empty, ordered, non-overlapping, and their position
+must be relative to `first` (as the tokens generated by `basic_analyze()` are).
+
+@param os: the stream to write to (should be opened in binary mode)
+@param first: points to the the start of the text the tokens were found in
+@param last: points to one past the end of the text
+@param tokens: the tokens to write
+@param types: the list of token types used to give each type an ID; must contain the types of all tokens
+@throws std::invalid_argument if the type of a token is not in `types`
+*/
+template <typename RandomAccessIterator, typename TokenTypeT>
+void write_token_stream(std::ostream& os, RandomAccessIterator first, RandomAccessIterator last,
+                        const BasicTokenList<RandomAccessIterator, TokenTypeT>& tokens, const std::vector<TokenTypeT>& types);
+
+template <typename RandomAccessIterator, typename TokenTypeT>
+auto make_token_stream_view(const char* data, std::size_t size, RandomAccessIterator first, RandomAccessIterator last,
+                            const std::vector<TokenTypeT>& types)
+-> BasicTokenStreamView<RandomAccessIterator, TokenTypeT>;
+/*  convenience function that constructs and returns a `BasicTokenStreamView` object */
+
+}   // namespace `ogla`
+
+
+
+namespace ogla { namespace detail {
+
+const unsigned char tokenStreamMagic[] = {'O', 'G', 'L', 'T'};
+const unsigned char tokenStreamVersion = 1;
+
+/*
+writes `value` as an unsigned LEB128 varint
+*/
+inline void write_varint(std::ostream& os, std::uint64_t value) {
+    do {
+        auto byte = static_cast<unsigned char>(value & 0x7f);
+        value >>= 7;
+        if (value != 0)
+            byte |= 0x80;
+        os.put(static_cast<char>(byte));
+    } while (value != 0);
+}
+
+/*
+Reads an unsigned LEB128 varint starting at `pos` and moves `pos` past it.  Returns false if the varint is truncated
+or too large.
+*/
+inline bool read_varint(const unsigned char*& pos, const unsigned char* end, std::uint64_t& value) {
+    value = 0;
+    for (int shift = 0; pos != end && shift < 64; shift += 7) {
+        auto byte = *pos++;
+        value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+    return false;
+}
+
+}}  // namespace `ogla::detail`
+
+
+
+/*
+A `BasicTokenStreamView` reads the tokens stored in a token stream (see `write_token_stream()`) directly from memory,
+without copying the stream or running a lexer.  The memory can hold a whole stream read from a file, or be a file
+mapped into memory (e.g. with `mmap()`); in either case it must outlive the view.
+
+The stream is checked when the view is created.  If it is malformed, or was not created from the text given to the view
+(its length or hash differ), `valid()` returns false and the view contains no tokens.  The tokens read from the view
+are the same as the ones that were written, with their lexemes referring to the text given to the view.
+*/
+template <typename RandomAccessIterator, typename TokenTypeT>
+class ogla::BasicTokenStreamView {
+    public:
+        using Token = BasicToken<RandomAccessIterator, TokenTypeT>;
+        class Iterator;
+
+        BasicTokenStreamView(const char* data, std::size_t size, RandomAccessIterator _first, RandomAccessIterator _last,
+                             const std::vector<TokenTypeT>& _types);
+        /*  @param data: points to the start of the stream
+            @param size: the size of the stream in bytes
+            @param first: points to the the start of the text the tokens were found in
+            @param last: points to one past the end of the text
+            @param types: the list of token types that was used to write the stream
+        */
+
+        bool valid() const;
+        /*  returns true if the stream is well formed and was created from the text the view refers to */
+
+        std::size_t size() const;
+        /*  returns the number of tokens in the stream */
+
+        auto begin() const -> Iterator;
+        auto end() const -> Iterator;
+
+        auto tokens() const -> BasicTokenList<RandomAccessIterator, TokenTypeT>;
+        /*  returns a list of all the tokens in the stream */
+
+    private:
+        const unsigned char* records;   // points to the first token record
+        const unsigned char* recordsEnd;
+        RandomAccessIterator first;
+        RandomAccessIterator last;
+        std::vector<TokenTypeT> types;
+        std::size_t tokenCount;
+        bool isValid;
+};
+
+/*
+Iterates over the tokens of a `BasicTokenStreamView`, decoding one record at a time.
+*/
+template <typename RandomAccessIterator, typename TokenTypeT>
+class ogla::BasicTokenStreamView<RandomAccessIterator, TokenTypeT>::Iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Token;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Token*;
+        using reference = const Token&;
+
+        Iterator() = default;
+        Iterator(const BasicTokenStreamView* _view, const unsigned char* _pos, std::size_t _remaining)
+            : view{_view}, pos{_pos}, remaining{_remaining} {
+            decode();
+        }
+
+        auto operator*() const -> const Token& { return token; }
+        auto operator->() const -> const Token* { return &token; }
+
+        auto operator++() -> Iterator& {
+            --remaining;
+            decode();
+            return *this;
+        }
+
+        auto operator++(int) -> Iterator {
+            auto old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator==(const Iterator& other) const { return remaining == other.remaining; }
+        bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+    private:
+        void decode() {
+            // records were checked when the view was created, so they can be decoded without checking for errors
+            if (remaining == 0)
+                return;
+            std::uint64_t gap, length, type;
+            detail::read_varint(pos, view->recordsEnd, gap);
+            detail::read_varint(pos, view->recordsEnd, length);
+            detail::read_varint(pos, view->recordsEnd, type);
+            auto tokenPosition = offset + gap;
+            offset = tokenPosition + length;
+            token = Token{view->types[type], view->first + tokenPosition, view->first + offset, static_cast<int>(tokenPosition)};
+        }
+
+        const BasicTokenStreamView* view = nullptr;
+        const unsigned char* pos = nullptr;
+        std::size_t remaining = 0;
+        std::uint64_t offset = 0;   // the position right after the previous token
+        Token token;
+};
+
+
+
+/*
+@param data: points to the start of the stream
+@param size: the size of the stream in bytes
+@param first: points to the the start of the text the tokens were found in
+@param last: points to one past the end of the text
+@param types: the list of token types that was used to write the stream
+*/
+template <typename RandomAccessIterator, typename TokenTypeT>
+ogla::BasicTokenStreamView<RandomAccessIterator, TokenTypeT>::BasicTokenStreamView(const char* data, std::size_t size,
+        RandomAccessIterator _first, RandomAccessIterator _last, const std::vector<TokenTypeT>& _types)
+: records{nullptr}, recordsEnd{nullptr}, first{_first}, last{_last}, types{_types}, tokenCount{0}, isValid{false} {
+    auto pos = reinterpret_cast<const unsigned char*>(data);
+    auto end = pos + size;
+
+    // check the header
+    const auto headerSize = sizeof(detail::tokenStreamMagic) + 1;
+    if (size < headerSize || !std::equal(std::begin(detail::tokenStreamMagic), std::end(detail::tokenStreamMagic), pos)
+                          || pos[sizeof(detail::tokenStreamMagic)] != detail::tokenStreamVersion)
+        return;
+    pos += headerSize;
+
+    const auto textLength = static_cast<std::uint64_t>(last - first);
+    std::uint64_t length, typeCount, count;
+    if (!detail::read_varint(pos, end, length) || length != textLength || end - pos < 8)
+        return;
+    std::uint64_t hash = 0;
+    for (int i = 0; i < 8; i++)
+        hash |= static_cast<std::uint64_t>(*pos++) << (8 * i);
+    if (hash != text_hash(first, last))
+        return;
+    if (!detail::read_varint(pos, end, typeCount) || typeCount != types.size() || !detail::read_varint(pos, end, count))
+        return;
+
+    // check that every record can be decoded and refers to the text and known types
+    records = pos;
+    std::uint64_t offset = 0;
+    for (std::uint64_t i = 0; i < count; i++) {
+        std::uint64_t gap, tokenLength, type;
+        if (!detail::read_varint(pos, end, gap) || !detail::read_varint(pos, end, tokenLength) || !detail::read_varint(pos, end, type))
+            return;
+        if (gap > textLength - offset || tokenLength == 0 || tokenLength > textLength - offset - gap || type >= typeCount)
+            return;
+        offset += gap + tokenLength;
+    }
+    recordsEnd = pos;
+    tokenCount = count;
+    isValid = true;
+}
+
+/*
+returns true if the stream is well formed and was created from the text the view refers to
+*/
+template <typename RandomAccessIterator, typename TokenTypeT>
+bool ogla::BasicTokenStreamView<RandomAccessIterator, TokenTypeT>::valid() const {
+    return isValid;
+}
+
+/*
+returns the number of tokens in the stream
+*/
+template <typename RandomAccessIterator, typename TokenTypeT>
+std::size_t ogla::BasicTokenStreamView<RandomAccessIterator, TokenTypeT>::size() const {
+    return tokenCount;
+}
+
+template <typename RandomAccessIterator, typename TokenTypeT>
+auto ogla::BasicTokenStreamView<RandomAccessIterator, TokenTypeT>::begin() const -> Iterator {
+    return Iterator{this, records, tokenCount};
+}
+
+template <typename RandomAccessIterator, typename TokenTypeT>
+auto ogla::BasicTokenStreamView<RandomAccessIterator, TokenTypeT>::end() const -> Iterator {
+    return Iterator{};
+}
+
+/*
+returns a list of all the tokens in the stream
+*/
+template <typename RandomAccessIterator, typename TokenTypeT>
+auto ogla::BasicTokenStreamView<RandomAccessIterator, TokenTypeT>::tokens() const
+-> ogla::BasicTokenList<RandomAccessIterator, TokenTypeT> {
+    BasicTokenList<RandomAccessIterator, TokenTypeT> tokenList;
+    tokenList.reserve(tokenCount);
+    for (const auto& token : *this)
+        tokenList.push_back(token);
+    return tokenList;
+}
+
+
+
+/*
+returns the distinct token types found by the rules of a grammar, in the order they first appear
+*/
+template <typename TokenTypeT, typename charT>
+auto ogla::grammar_token_types(const BasicGrammar<TokenTypeT, charT>& grammar) -> std::vector<TokenTypeT> {
+    std::vector<TokenTypeT> types;
+    for (const auto& ruleList : grammar) {
+        for (const auto& rule : ruleList) {
+            if (std::find(types.cbegin(), types.cend(), rule.type()) == types.cend())
+                types.push_back(rule.type());
+        }
+    }
+    return types;
+}
+
+/*
+returns the hash of some text that is recorded in token streams (64 bit FNV-1a)
+*/
+template <typename RandomAccessIterator>
+auto ogla::text_hash(RandomAccessIterator first, RandomAccessIterator last) -> std::uint64_t {
+    using CharType = typename std::iterator_traits<RandomAccessIterator>::value_type;
+
+    std::uint64_t hash = 14695981039346656037ull;
+    for (; first != last; ++first) {
+        auto c = static_cast<std::uint64_t>(*first);
+        for (std::size_t i = 0; i < sizeof(CharType); i++) {   // hash every byte of wide characters
+            hash ^= (c >> (8 * i)) & 0xff;
+            hash *= 1099511628211ull;
+        }
+    }
+    return hash;
+}
+
+/*
+Writes a list of tokens to a stream.
+*/
+template <typename RandomAccessIterator, typename TokenTypeT>
+void ogla::write_token_stream(std::ostream& os, RandomAccessIterator first, RandomAccessIterator last,
+                              const BasicTokenList<RandomAccessIterator, TokenTypeT>& tokens, const std::vector<TokenTypeT>& types) {
+    os.write(reinterpret_cast<const char*>(detail::tokenStreamMagic), sizeof(detail::tokenStreamMagic));
+    os.put(static_cast<char>(detail::tokenStreamVersion));
+    detail::write_varint(os, last - first);
+    auto hash = text_hash(first, last);
+    for (int i = 0; i < 8; i++)
+        os.put(static_cast<char>((hash >> (8 * i)) & 0xff));
+    detail::write_varint(os, types.size());
+    detail::write_varint(os, tokens.size());
+
+    std::uint64_t offset = 0;   // the position right after the previous token
+    for (const auto& token : tokens) {
+        auto type = std::find(types.cbegin(), types.cend(), token.type());
+        if (type == types.cend())
+            throw std::invalid_argument("ogla::write_token_stream: token type not found in type list");
+        detail::write_varint(os, token.position() - offset);
+        detail::write_varint(os, token.length());
+        detail::write_varint(os, type - types.cbegin());
+        offset = token.position() + token.length();
+    }
+}
+
+/*
+convenience function that constructs and returns a `BasicTokenStreamView` object
+*/
+template <typename RandomAccessIterator, typename TokenTypeT>
+auto ogla::make_token_stream_view(const char* data, std::size_t size, RandomAccessIterator first, RandomAccessIterator last,
+                                  const std::vector<TokenTypeT>& types)
+-> ogla::BasicTokenStreamView<RandomAccessIterator, TokenTypeT> {
+    return BasicTokenStreamView<RandomAccessIterator, TokenTypeT>{data, size, first, last, types};
+}
+
+#endif//OGLA_TOKEN_STREAM_HPP
@@ -0,0 +1,153 @@
+/*
+Project: OGLA
+File: allocation_test.cpp
+Author: Leonardo Banderali
+Created: October 18, 2026
+Last Modified: October 18, 2026
+
+Description: Checks that `ogla::BasicLexer` does not allocate memory once it has found its first token.
+
+Copyright (C) 2015 Leonardo Banderali
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <new>
+
+#include "ogla/ogla.hpp"
+
+#define BOOST_TEST_MODULE MyTest
+#include <boost/test/unit_test.hpp>
+
+//~counting allocator~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+// the number of times the global `operator new` has been called (`operator new[]` forwards to it)
+static std::size_t allocation_count = 0;
+
+void* operator new(std::size_t size) {
+    ++allocation_count;
+    if (void* p = std::malloc(size == 0 ? 1 : size))
+        return p;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+//~test subjects~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+//the string to be analyzed
+const std::string text{"The quick brown fox jumps over the lazy dog.\n"
+                 "foo bar quux\n"
+                 "gosofooeiowe secbarsde qux quuuuuuuuuux\n"
+                 "This is \"an \\t attempt\" to parse a string\n"};
+
+// the test rules to be used by the lexer
+const auto grammar = ogla::make_basic_grammar({
+    {   // objects must convert explicitly constructed because parameters are templated
+        ogla::make_basic_rule(std::string("foo_rule"), std::regex("foo"), 0),
+        ogla::make_basic_rule(std::string("bar_rule"), std::regex("\\bbar\\b"), 0),
+        ogla::make_basic_rule(std::string("quux_rule"), std::regex("\\bqu+x\\b"), 0),
+        ogla::make_basic_rule(std::string("quick_rule"), std::regex("\\bquick\\b"), 0),
+        ogla::make_basic_rule(std::string("c_rule"), std::regex("\\b[A-Za-z]+c[A-Za-z]+\\b"), 0),
+        ogla::make_basic_rule(std::string("str_rule"), std::regex("\""), 1)
+    }
+    ,
+    {
+        ogla::make_basic_rule(std::string("escape_rule"), std::regex("\\\\."), 1),
+        ogla::make_basic_rule(std::string("end_str_rule"), std::regex("\""), 0)
+    }
+});
+
+const int expected_token_count = 11;
+
+
+
+//~helpers~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/*
+Returns the number of allocations `std::regex_search` itself makes when the rules in `ruleList` are used to search the
+text starting at `position`.  Some standard library implementations allocate scratch space on every search; this is
+outside the lexer's control, so it is the most the lexer is allowed to allocate when looking for a token.
+*/
+std::size_t regex_search_allocations(std::string::const_iterator position, const std::vector<ogla::BasicGrammarRule<std::string, char>>& ruleList) {
+    std::match_results<std::string::const_iterator> m;
+    for (const auto& r : ruleList)
+        std::regex_search(position, text.cend(), m, r.regex());   // make sure `m` has all the storage it needs
+
+    auto before = allocation_count;
+    for (const auto& r : ruleList)
+        std::regex_search(position, text.cend(), m, r.regex());
+    return allocation_count - before;
+}
+
+/*
+Returns the grammar index the lexer should be in after finding `token` while in state `ruleList`.
+*/
+ogla::BasicGrammarIndex next_rule_list(ogla::BasicGrammarIndex ruleList, const std::string& tokenType) {
+    for (const auto& r : grammar[ruleList]) {
+        if (r.type() == tokenType)
+            return r.nextState();
+    }
+    return -1;
+}
+
+
+
+//~tests~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+BOOST_AUTO_TEST_CASE( test_BasicLexer_allocations ) {
+    // pre-test code (constructing the lexer finds the first token, which warms it up)
+    auto lexer = ogla::make_lexer(text.cbegin(), text.cend(), grammar);
+    ogla::BasicGrammarIndex ruleList = next_rule_list(0, lexer.current().type());
+
+    // run test
+    for (int i = 1; i < expected_token_count; i++) {
+        auto position = text.cbegin() + lexer.current().position() + lexer.current().lexeme().size();
+        auto allowed = regex_search_allocations(position, grammar[ruleList]);
+
+        // alternate between peeking before moving on (which must not search again) and moving on directly
+        std::size_t peek_allocations = 0;
+        if (i % 2 == 0) {
+            auto before = allocation_count;
+            lexer.peek();
+            peek_allocations = allocation_count - before;
+        }
+        auto before = allocation_count;
+        const auto& token = lexer.next();
+        auto next_allocations = allocation_count - before;
+
+        BOOST_CHECK_MESSAGE(!token.empty(), "token " << i << " is empty");
+        BOOST_CHECK_MESSAGE(peek_allocations + next_allocations == allowed,
+                            "token " << i << ": " << (peek_allocations + next_allocations)
+                            << " allocations, std::regex_search makes " << allowed);
+
+        before = allocation_count;
+        auto copy = lexer.current();
+        auto copy_allocations = allocation_count - before;
+        BOOST_CHECK_MESSAGE(copy_allocations == 0, "copying token " << i << " made " << copy_allocations << " allocations");
+        BOOST_CHECK(copy == token);
+
+        ruleList = next_rule_list(ruleList, token.type());
+    }
+
+    // once there are no more tokens, the lexer should not keep searching the text
+    auto position = text.cbegin() + lexer.current().position() + lexer.current().lexeme().size();
+    auto allowed = regex_search_allocations(position, grammar[ruleList]);
+    auto before = allocation_count;
+    lexer.next();
+    lexer.peek();
+    lexer.next();
+    auto end_allocations = allocation_count - before;
+    BOOST_CHECK(lexer.current().empty());
+    BOOST_CHECK_MESSAGE(end_allocations == allowed, end_allocations << " allocations at the end of the text, std::regex_search makes " << allowed);
+}
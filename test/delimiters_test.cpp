@@ -0,0 +1,106 @@
+/*
+Project: OGLA
+File: delimiters_test.cpp
+Author: Leonardo Banderali
+Created: October 18, 2026
+Last Modified: October 18, 2026
+
+Description: A simple unit test for rules using `ogla::BasicDelimiters`.
+
+Copyright (C) 2015 Leonardo Banderali
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+
+#include <string>
+#include <vector>
+#include <tuple>
+
+#include "ogla/ogla.hpp"
+
+#define BOOST_TEST_MODULE MyTest
+#include <boost/test/unit_test.hpp>
+
+//~test subjects~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+//the string to be analyzed (long enough for spans to cross several 16 byte blocks, and ending with unterminated spans)
+const std::string text{"key = \"a string with an \\\"escaped\\\" quote and a \\\\ backslash\" # comment\n"
+                       "/* a block /* with a nested */ comment that goes on for a while */ foo \"\"\n"
+                       "bar = \"short\" /* unterminated \"comment"};
+
+// the test rules to be used by the lexer
+const auto grammar = ogla::make_basic_grammar({
+    {
+        ogla::make_basic_rule(std::string("str_rule"), ogla::BasicDelimiters<char>{"\"", "\"", "\\"}, 0),
+        ogla::make_basic_rule(std::string("comment_rule"), ogla::BasicDelimiters<char>{"/*", "*/", "", true}, 0),
+        ogla::make_basic_rule(std::string("foo_rule"), std::regex("foo"), 0),
+        ogla::make_basic_rule(std::string("bar_rule"), std::regex("\\bbar\\b"), 0)
+    }
+});
+
+// a representation of the tokens expected from the lexer
+const std::vector<std::tuple<std::string, std::string, int>> expected_tokens = {
+    std::make_tuple("str_rule", "\"a string with an \\\"escaped\\\" quote and a \\\\ backslash\"", 6),
+    std::make_tuple("comment_rule", "/* a block /* with a nested */ comment that goes on for a while */", 72),
+    std::make_tuple("foo_rule", "foo", 139),
+    std::make_tuple("str_rule", "\"\"", 143),
+    std::make_tuple("bar_rule", "bar", 146),
+    std::make_tuple("str_rule", "\"short\"", 152)
+};
+
+
+
+//~helpers~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+// a macro that generates the message to be printed by a BOOST_CHECK_MESSAGE
+#define MAKE_MESSAGE(token, tuple) "expected:{" << std::get<0>(tuple) << "," << std::get<1>(tuple) << "," << std::get<2>(tuple) \
+                                                << "} got:{" << (token.type()) << "," << (token.lexeme()) << "," << (token.position()) << "}"
+
+
+
+//~tests~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+BOOST_AUTO_TEST_CASE( test_delimited_analyze ) {
+    // pre-test code
+    auto tokens = ogla::basic_analyze(text.cbegin(), text.cend(), grammar);
+
+    // run test
+    BOOST_REQUIRE(tokens.size() == expected_tokens.size());
+    for (int i = 0, s = tokens.size(); i < s; i++) {
+        auto token = tokens.at(i);
+        BOOST_CHECK_MESSAGE(token.type() == std::get<0>(expected_tokens[i]), MAKE_MESSAGE(token,(expected_tokens[i])));
+        BOOST_CHECK_MESSAGE(token.lexeme() == std::get<1>(expected_tokens[i]), MAKE_MESSAGE(token,(expected_tokens[i])));
+        BOOST_CHECK_MESSAGE(token.position() == std::get<2>(expected_tokens[i]), MAKE_MESSAGE(token,(expected_tokens[i])));
+    }
+}
+
+BOOST_AUTO_TEST_CASE( test_delimited_generic_iterators ) {
+    // pre-test code (the text in a `std::vector` is not scanned using the fast path for `std::string`)
+    const std::vector<char> chars(text.cbegin(), text.cend());
+    auto expected = ogla::basic_analyze(text.cbegin(), text.cend(), grammar);
+    auto tokens = ogla::basic_analyze(chars.cbegin(), chars.cend(), grammar);
+
+    // run test
+    BOOST_REQUIRE(tokens.size() == expected.size());
+    for (int i = 0, s = tokens.size(); i < s; i++) {
+        BOOST_TEST(tokens[i].type() == expected[i].type());
+        BOOST_TEST(tokens[i].lexeme() == expected[i].lexeme());
+        BOOST_TEST(tokens[i].position() == expected[i].position());
+    }
+}
+
+BOOST_AUTO_TEST_CASE( test_find_delimited ) {
+    const ogla::BasicDelimiters<char> str{"'", "'", "\\"};
+    const std::string escapedEnd{"'abc\\"};
+    const std::string lateOpen(40, 'x');
+    std::string::const_iterator spanFirst, spanLast;
+
+    BOOST_TEST(!ogla::find_delimited(escapedEnd.cbegin(), escapedEnd.cend(), str, spanFirst, spanLast));
+    BOOST_TEST(!ogla::find_delimited(lateOpen.cbegin(), lateOpen.cend(), str, spanFirst, spanLast));
+
+    const std::string twoSpans = lateOpen + "'y''z'";
+    BOOST_REQUIRE(ogla::find_delimited(twoSpans.cbegin(), twoSpans.cend(), str, spanFirst, spanLast));
+    BOOST_TEST((spanFirst - twoSpans.cbegin()) == 40);
+    BOOST_TEST((spanLast - twoSpans.cbegin()) == 43);
+}
@@ -0,0 +1,129 @@
+/*
+Project: OGLA
+File: optimizer_test.cpp
+Author: Leonardo Banderali
+Created: October 18, 2026
+Last Modified: October 18, 2026
+
+Description: A simple unit test for `ogla::optimize_grammar()`.
+
+Copyright (C) 2015 Leonardo Banderali
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+
+#include <string>
+#include <vector>
+#include <sstream>
+
+#include "ogla/ogla.hpp"
+
+#define BOOST_TEST_MODULE MyTest
+#include <boost/test/unit_test.hpp>
+
+//~test subjects~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+//the string to be analyzed
+const std::string text{"if x+1 else iffy ++ while 42 \"a\\tb\" elsewhere\n"
+                       "whilex+ifelse abba a ab 7 ++if\"\\\"\"else"};
+
+// the test rules to be optimized
+const auto grammar = ogla::make_basic_grammar({
+    {
+        ogla::make_basic_rule(std::string("keyword"), std::string("if"), 0),
+        ogla::make_basic_rule(std::string("op"), std::string("\\+"), 0),
+        ogla::make_basic_rule(std::string("keyword"), std::string("else"), 0),      // merged with rule 0
+        ogla::make_basic_rule(std::string("keyword"), std::string("iffy"), 0),      // shadowed by rule 0
+        ogla::make_basic_rule(std::string("op"), std::string("\\+\\+"), 0),         // shadowed by rule 1
+        ogla::make_basic_rule(std::string("number"), std::string("[0-9]+"), 0),
+        ogla::make_basic_rule(std::string("keyword"), std::string("while"), 0),     // can't move past rule 5
+        ogla::make_basic_rule(std::string("ab"), std::string("ab"), 0),
+        ogla::make_basic_rule(std::string("ab"), std::string("a"), 0),              // merged with rule 7
+        ogla::make_basic_rule(std::string("str"), std::string("\""), 1),
+        ogla::make_basic_rule(std::string("number"), std::string("[0-9]+"), 0)      // shadowed by rule 5
+    }
+    ,
+    {
+        ogla::make_basic_rule(std::string("escape"), std::string("\\\\."), 1),
+        ogla::make_basic_rule(std::string("end_str"), std::string("\""), 0)
+    }
+    ,
+    {
+        ogla::make_basic_rule(std::string("dead"), std::string("x"), 2)
+    }
+});
+
+
+
+//~tests~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+BOOST_AUTO_TEST_CASE( test_optimize_grammar_report ) {
+    // pre-test code
+    ogla::GrammarReport report;
+    auto optimized = ogla::optimize_grammar(grammar, &report);
+
+    // run test
+    BOOST_TEST(report.unreachableStates == std::vector<ogla::BasicGrammarIndex>{2});
+    BOOST_TEST(report.danglingRules.empty());
+
+    BOOST_REQUIRE(report.shadowedRules.size() == 3);
+    BOOST_TEST(report.shadowedRules[0].rule == 3);
+    BOOST_TEST(report.shadowedRules[0].shadowedBy == 0);
+    BOOST_TEST(report.shadowedRules[1].rule == 4);
+    BOOST_TEST(report.shadowedRules[1].shadowedBy == 1);
+    BOOST_TEST(report.shadowedRules[2].rule == 10);
+    BOOST_TEST(report.shadowedRules[2].shadowedBy == 5);
+
+    BOOST_REQUIRE(report.mergedRules.size() == 2);
+    BOOST_TEST(report.mergedRules[0].rules == (std::vector<int>{0, 2}));
+    BOOST_TEST(report.mergedRules[1].rules == (std::vector<int>{7, 8}));
+
+    BOOST_REQUIRE(optimized.size() == grammar.size());
+    BOOST_TEST(optimized[0].size() == 6);
+    BOOST_TEST(optimized[0][0].pattern() == "if|else");
+    BOOST_TEST(optimized[0][4].pattern() == "ab|a");
+    BOOST_TEST(optimized[1].size() == 2);
+    BOOST_TEST(optimized[2].empty());
+
+    std::ostringstream os;
+    os << report;
+    BOOST_TEST(os.str() == "state 2 is unreachable\n"
+                           "state 0, rule 3: can never match, always shadowed by rule 0\n"
+                           "state 0, rule 4: can never match, always shadowed by rule 1\n"
+                           "state 0, rule 10: can never match, always shadowed by rule 5\n"
+                           "state 0, rules 0 2: merged into a single literal alternation\n"
+                           "state 0, rules 7 8: merged into a single literal alternation\n");
+}
+
+BOOST_AUTO_TEST_CASE( test_optimize_grammar_tokens ) {
+    // pre-test code
+    auto optimized = ogla::optimize_grammar(grammar);
+    auto expected = ogla::basic_analyze(text.cbegin(), text.cend(), grammar);
+    auto tokens = ogla::basic_analyze(text.cbegin(), text.cend(), optimized);
+
+    // run test
+    BOOST_TEST(expected.size() == 29);
+    BOOST_CHECK(tokens == expected);
+}
+
+BOOST_AUTO_TEST_CASE( test_optimize_grammar_opaque_rules ) {
+    // pre-test code (rules created from regex objects can't be inspected, so they are kept as they are)
+    const auto opaque = ogla::make_basic_grammar({
+        {
+            ogla::make_basic_rule(std::string("foo_rule"), std::regex("foo"), 0),
+            ogla::make_basic_rule(std::string("foo_rule"), std::regex("bar"), 0),
+            ogla::make_basic_rule(std::string("foo_rule"), std::regex("foo"), 3)
+        }
+    });
+    ogla::GrammarReport report;
+    auto optimized = ogla::optimize_grammar(opaque, &report);
+
+    // run test
+    BOOST_TEST(optimized[0].size() == 3);
+    BOOST_TEST(report.shadowedRules.empty());
+    BOOST_TEST(report.mergedRules.empty());
+    BOOST_REQUIRE(report.danglingRules.size() == 1);
+    BOOST_TEST(report.danglingRules[0].rule == 2);
+    BOOST_TEST(report.danglingRules[0].nextState == 3);
+}
@@ -0,0 +1,122 @@
+/*
+Project: OGLA
+File: token_stream_test.cpp
+Author: Leonardo Banderali
+Created: October 18, 2026
+Last Modified: October 18, 2026
+
+Description: A simple unit test for `ogla::write_token_stream()` and `ogla::BasicTokenStreamView`.
+
+Copyright (C) 2015 Leonardo Banderali
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+
+#include <string>
+#include <vector>
+#include <sstream>
+#include <stdexcept>
+
+#include "ogla/ogla.hpp"
+
+#define BOOST_TEST_MODULE MyTest
+#include <boost/test/unit_test.hpp>
+
+//~test subjects~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+//the string to be analyzed
+const std::string text{"The quick brown fox jumps over the lazy dog.\n"
+                 "foo bar quux\n"
+                 "gosofooeiowe secbarsde qux quuuuuuuuuux\n"
+                 "This is \"an \\t attempt\" to parse a string\n"};
+
+// the test rules to be used by the lexer
+const auto grammar = ogla::make_basic_grammar({
+    {   // objects must convert explicitly constructed because parameters are templated
+        ogla::make_basic_rule(std::string("foo_rule"), std::regex("foo"), 0),
+        ogla::make_basic_rule(std::string("bar_rule"), std::regex("\\bbar\\b"), 0),
+        ogla::make_basic_rule(std::string("quux_rule"), std::regex("\\bqu+x\\b"), 0),
+        ogla::make_basic_rule(std::string("quick_rule"), std::regex("\\bquick\\b"), 0),
+        ogla::make_basic_rule(std::string("c_rule"), std::regex("\\b[A-Za-z]+c[A-Za-z]+\\b"), 0),
+        ogla::make_basic_rule(std::string("str_rule"), std::regex("\""), 1)
+    }
+    ,
+    {
+        ogla::make_basic_rule(std::string("escape_rule"), std::regex("\\\\."), 1),
+        ogla::make_basic_rule(std::string("end_str_rule"), std::regex("\""), 0)
+    }
+});
+
+const auto types = ogla::grammar_token_types(grammar);
+
+
+
+//~helpers~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/*
+returns the token stream for the tokens found in `text`
+*/
+std::string make_stream() {
+    std::ostringstream os;
+    ogla::write_token_stream(os, text.cbegin(), text.cend(), ogla::basic_analyze(text.cbegin(), text.cend(), grammar), types);
+    return os.str();
+}
+
+
+
+//~tests~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+BOOST_AUTO_TEST_CASE( test_grammar_token_types ) {
+    BOOST_TEST(types == (std::vector<std::string>{"foo_rule", "bar_rule", "quux_rule", "quick_rule", "c_rule",
+                                                  "str_rule", "escape_rule", "end_str_rule"}));
+}
+
+BOOST_AUTO_TEST_CASE( test_token_stream_round_trip ) {
+    // pre-test code
+    auto expected = ogla::basic_analyze(text.cbegin(), text.cend(), grammar);
+    auto stream = make_stream();
+    auto view = ogla::make_token_stream_view(stream.data(), stream.size(), text.cbegin(), text.cend(), types);
+
+    // run test
+    BOOST_TEST(view.valid());
+    BOOST_TEST(view.size() == expected.size());
+    BOOST_CHECK(view.tokens() == expected);
+    BOOST_TEST(stream.size() == 4 + 1 + 2 + 8 + 1 + 1 + 3 * expected.size());   // every varint fits in a byte here
+
+    int i = 0;
+    for (const auto& token : view) {
+        BOOST_TEST(token.lexeme() == expected[i].lexeme());
+        i++;
+    }
+    BOOST_TEST(i == static_cast<int>(expected.size()));
+}
+
+BOOST_AUTO_TEST_CASE( test_token_stream_invalid ) {
+    // pre-test code
+    auto stream = make_stream();
+    auto changedText = text;
+    changedText[0] = 't';
+    auto shorterText = text.substr(0, text.size() - 1);
+
+    // run test
+    auto changed = ogla::make_token_stream_view(stream.data(), stream.size(), changedText.cbegin(), changedText.cend(), types);
+    BOOST_TEST(!changed.valid());
+    BOOST_TEST(changed.size() == 0);
+    BOOST_CHECK(changed.begin() == changed.end());
+
+    auto shorter = ogla::make_token_stream_view(stream.data(), stream.size(), shorterText.cbegin(), shorterText.cend(), types);
+    BOOST_TEST(!shorter.valid());
+
+    auto truncated = ogla::make_token_stream_view(stream.data(), stream.size() - 1, text.cbegin(), text.cend(), types);
+    BOOST_TEST(!truncated.valid());
+
+    auto otherTypes = types;
+    otherTypes.pop_back();
+    auto wrongTypes = ogla::make_token_stream_view(stream.data(), stream.size(), text.cbegin(), text.cend(), otherTypes);
+    BOOST_TEST(!wrongTypes.valid());
+
+    auto tokens = ogla::basic_analyze(text.cbegin(), text.cend(), grammar);
+    std::ostringstream os;
+    BOOST_CHECK_THROW(ogla::write_token_stream(os, text.cbegin(), text.cend(), tokens, otherTypes), std::invalid_argument);
+}